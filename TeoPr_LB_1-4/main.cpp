@@ -9,16 +9,182 @@
 
 using namespace std;
 
+// Relation store: sparse sorted rows while few relations are known, dense matrix afterwards
+class RelationStore {
+public:
+    // Share of known cells after which the store switches to the dense layout
+    static constexpr double kDenseThreshold = 0.25;
+
+    explicit RelationStore(int n = 0)
+        : n_(n), known_(0), dense_(false), rows_(n) {}
+
+    RelationStore(const vector<vector<int>>& matrix)
+        : RelationStore(static_cast<int>(matrix.size())) {
+        for (int i = 0; i < n_; ++i) {
+            for (int j = 0; j < n_; ++j) {
+                if (matrix[i][j] != 0) {
+                    store(i, j, matrix[i][j]);
+                }
+            }
+        }
+        promoteIfDense();
+    }
+
+    int size() const {
+        return n_;
+    }
+
+    bool isDense() const {
+        return dense_;
+    }
+
+    int knownCount() const {
+        return known_;
+    }
+
+    int get(int i, int j) const {
+        if (dense_) {
+            return cells_[i][j];
+        }
+        auto it = rows_[i].find(j);
+        return it == rows_[i].end() ? 0 : it->second;
+    }
+
+    void set(int i, int j, int value) {
+        store(i, j, value);
+        promoteIfDense();
+    }
+
+    // Known relations of row i in column order (only valid in the sparse layout)
+    const map<int, int>& row(int i) const {
+        return rows_[i];
+    }
+
+    vector<vector<int>> toDense() const {
+        if (dense_) {
+            return cells_;
+        }
+        vector<vector<int>> matrix(n_, vector<int>(n_, 0));
+        for (int i = 0; i < n_; ++i) {
+            for (const auto& cell : rows_[i]) {
+                matrix[i][cell.first] = cell.second;
+            }
+        }
+        return matrix;
+    }
+
+    // Switch to the dense layout regardless of the threshold
+    void makeDense() {
+        if (dense_) {
+            return;
+        }
+        cells_ = toDense();
+        rows_.clear();
+        dense_ = true;
+    }
+
+    // Transitive logic: 1 (better) and 3 (worse) propagate through 1/2 and 3/2 respectively
+    void updateTransitiveRelations() {
+        if (dense_) {
+            updateDense();
+        }
+        else {
+            updateSparse();
+        }
+        promoteIfDense();
+    }
+
+private:
+    void store(int i, int j, int value) {
+        if (dense_) {
+            int& cell = cells_[i][j];
+            known_ += (cell == 0) - (value == 0);
+            cell = value;
+            return;
+        }
+        if (value == 0) {
+            known_ -= static_cast<int>(rows_[i].erase(j));
+            return;
+        }
+        auto result = rows_[i].insert(make_pair(j, value));
+        if (result.second) {
+            ++known_;
+        }
+        else {
+            result.first->second = value;
+        }
+    }
+
+    void promoteIfDense() {
+        if (!dense_ && n_ > 0 && known_ > kDenseThreshold * n_ * n_) {
+            makeDense();
+        }
+    }
+
+    void updateDense() {
+        for (int i = 0; i < n_; ++i) {
+            for (int j = 0; j < n_; ++j) {
+                if (cells_[i][j] == 1) {
+                    for (int k = 0; k < n_; ++k) {
+                        if (cells_[j][k] != 0 && cells_[i][k] == 0) {
+                            if (cells_[j][k] == 1 || cells_[j][k] == 2) {
+                                cells_[i][k] = 1;
+                                ++known_;
+                            }
+                        }
+                    }
+                }
+                else if (cells_[i][j] == 3) {
+                    for (int k = 0; k < n_; ++k) {
+                        if (cells_[j][k] != 0 && cells_[i][k] == 0) {
+                            if (cells_[j][k] == 3 || cells_[j][k] == 2) {
+                                cells_[i][k] = 3;
+                                ++known_;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Same pass as updateDense, but only over known edges. Map iterators survive insertion,
+    // so relations added to row i behind the cursor are visited later, exactly as in the dense scan.
+    void updateSparse() {
+        for (int i = 0; i < n_; ++i) {
+            for (auto ij = rows_[i].begin(); ij != rows_[i].end(); ++ij) {
+                int relation = ij->second;
+                if (relation != 1 && relation != 3) {
+                    continue;
+                }
+                for (const auto& jk : rows_[ij->first]) {
+                    if (jk.second == relation || jk.second == 2) {
+                        if (rows_[i].insert(make_pair(jk.first, relation)).second) {
+                            ++known_;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    int n_;
+    int known_;
+    bool dense_;
+    vector<map<int, int>> rows_;
+    vector<vector<int>> cells_;
+};
+
 // Observer pattern
 class Observer {
 public:
     virtual void update() = 0;
 };
-void printMatrix(const vector<string>& numbers, const vector<vector<int>>& matrix);
+void printMatrix(const vector<string>& numbers, const RelationStore& matrix);
 
 class MatrixObserver : public Observer {
 public:
-    MatrixObserver(vector<vector<int>>& matrix, const vector<string>& numbers)
+    MatrixObserver(RelationStore& matrix, const vector<string>& numbers)
         : matrix_(matrix), numbers_(numbers) {}
 
     void update() override {
@@ -26,7 +192,7 @@ public:
         printMatrix(numbers_, matrix_);
     }
 
-    vector<vector<int>>& getMatrix() {
+    RelationStore& getMatrix() {
         return matrix_;
     }
 
@@ -35,7 +201,7 @@ public:
     }
 
 private:
-    vector<vector<int>>& matrix_;
+    RelationStore& matrix_;
     const vector<string>& numbers_;
 };
 
@@ -50,7 +216,7 @@ public:
         decoratedMatrixObserver_.update();
     }
 
-    vector<vector<int>>& getMatrix() {
+    RelationStore& getMatrix() {
         return decoratedMatrixObserver_.getMatrix();
     }
 
@@ -82,7 +248,7 @@ private:
 // Strategy pattern
 class Comparator {
 public:
-    virtual int compare(const string& num1, const string& num2, vector<vector<int>>& matrix) = 0;
+    virtual int compare(const string& num1, const string& num2, RelationStore& matrix) = 0;
     virtual ~Comparator() {}
 };
 
@@ -90,12 +256,12 @@ class SimpleComparator : public Comparator {
 public:
     SimpleComparator(const vector<string>& numbers) : numbers(numbers) {}
 
-    int compare(const string& num1, const string& num2, vector<vector<int>>& matrix) override {
+    int compare(const string& num1, const string& num2, RelationStore& matrix) override {
         int i = find(numbers.begin(), numbers.end(), num1) - numbers.begin();
         int j = find(numbers.begin(), numbers.end(), num2) - numbers.begin();
 
-        if (matrix[i][j] != 0) {
-            return matrix[i][j];
+        if (matrix.get(i, j) != 0) {
+            return matrix.get(i, j);
         }
 
         int choice;
@@ -104,7 +270,7 @@ public:
             cin >> choice;
         } while (choice < 1 || choice > 3);
 
-        matrix[i][j] = choice;
+        matrix.set(i, j, choice);
         return choice;
     }
 
@@ -116,7 +282,7 @@ private:
 class AbstractFactory {
 public:
     virtual Comparator* createComparator(const vector<string>& numbers) = 0;
-    virtual Observer* createObserver(vector<vector<int>>& matrix, const vector<string>& numbers) = 0;
+    virtual Observer* createObserver(RelationStore& matrix, const vector<string>& numbers) = 0;
 };
 
 class ComparatorFactory : public AbstractFactory {
@@ -125,7 +291,7 @@ public:
         return new SimpleComparator(numbers);
     }
 
-    Observer* createObserver(vector<vector<int>>& matrix, const vector<string>& numbers) override {
+    Observer* createObserver(RelationStore& matrix, const vector<string>& numbers) override {
         return nullptr;
     }
 };
@@ -136,7 +302,7 @@ public:
         return nullptr;
     }
 
-    Observer* createObserver(vector<vector<int>>& matrix, const vector<string>& numbers) override {
+    Observer* createObserver(RelationStore& matrix, const vector<string>& numbers) override {
         MatrixObserver* matrixObserver = new MatrixObserver(matrix, numbers);
         return new MatrixLoggerDecorator(*matrixObserver);
     }
@@ -162,9 +328,9 @@ int criteriaValues[4][4] = {
 };
 
 // Initialisation of all functions
-void fillDiagonalWithTwo(vector<vector<int>>& matrix, const vector<string>& numbers);
-void compareAndFillMatrix(vector<vector<int>>& matrix, const vector<string>& numbers, Comparator& comparator, MatrixObserver& observer);
-void printInitialAndFinalMatrix(const vector<vector<int>>& matrix, const vector<string>& numbers);
+void fillDiagonalWithTwo(RelationStore& matrix, const vector<string>& numbers);
+void compareAndFillMatrix(RelationStore& matrix, const vector<string>& numbers, Comparator& comparator, MatrixObserver& observer);
+void printInitialAndFinalMatrix(const RelationStore& matrix, const vector<string>& numbers);
 void printAlternatives(const vector<string>& numbers, const vector<pair<string, int>>& ranked_numbers);
 void createRankedNumbers(const vector<string>& numbers, const vector<string>& epors);
 void printVectorValuation(const int initial[4][4]);
@@ -177,6 +343,7 @@ void test_compareNumbers(double& tests_passed);
 void test_matrix_initialization(double& tests_passed);
 void test_ranked_numbers(double& tests_passed);
 void test_updateTransitiveRelations(double& tests_passed);
+void test_relationStore(double& tests_passed);
 void runTests();
 void runProgram();
 
@@ -204,12 +371,13 @@ int main()
 //
 void runTests() {
     double tests_passed = 0;
-    double all_tests = 4;
+    double all_tests = 5;
     cout << "Running tests..." << endl << endl;
     test_compareNumbers(tests_passed);
     test_matrix_initialization(tests_passed);
     test_ranked_numbers(tests_passed);
     test_updateTransitiveRelations(tests_passed);
+    test_relationStore(tests_passed);
 
     cout << "Values of passed tests: " << tests_passed << endl;
 
@@ -227,8 +395,8 @@ void runTests() {
 void runProgram() {
     cout << "Running program..." << endl << endl;
 
-    // Matrix to store the comparison results
-    vector<vector<int>> matrix = {
+    // Matrix to store the comparison results (starts sparse, becomes dense as answers accumulate)
+    RelationStore matrix = vector<vector<int>>{
       {2, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0},
       {0, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0},
       {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0},
@@ -284,7 +452,7 @@ void runProgram() {
 ///
 
 // Function to compare two numbers based on user input and existing matrix
-int compareNumbers(const string& num1, const string& num2, vector<vector<int>>& matrix, Comparator& comparator, MatrixObserver& observer)
+int compareNumbers(const string& num1, const string& num2, RelationStore& matrix, Comparator& comparator, MatrixObserver& observer)
 {
     int result = comparator.compare(num1, num2, matrix);
     observer.update();
@@ -292,45 +460,13 @@ int compareNumbers(const string& num1, const string& num2, vector<vector<int>>&
 }
 
 // Function of transitive logic
-void updateTransitiveRelations(vector<vector<int>>& matrix)
+void updateTransitiveRelations(RelationStore& matrix)
 {
-    int n = matrix.size();
-    for (int i = 0; i < n; ++i)
-    {
-        for (int j = 0; j < n; ++j)
-        {
-            if (matrix[i][j] == 1)
-            {
-                for (int k = 0; k < n; ++k)
-                {
-                    if (matrix[j][k] != 0 && matrix[i][k] == 0)
-                    {
-                        if (matrix[j][k] == 1 || matrix[j][k] == 2)
-                        {
-                            matrix[i][k] = 1;
-                        }
-                    }
-                }
-            }
-            else if (matrix[i][j] == 3)
-            {
-                for (int k = 0; k < n; ++k)
-                {
-                    if (matrix[j][k] != 0 && matrix[i][k] == 0)
-                    {
-                        if (matrix[j][k] == 3 || matrix[j][k] == 2)
-                        {
-                            matrix[i][k] = 3;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    matrix.updateTransitiveRelations();
 }
 
 // Function to print the matrix
-void printMatrix(const vector<string>& numbers, const vector<vector<int>>& matrix) {
+void printMatrix(const vector<string>& numbers, const RelationStore& matrix) {
     // String header output
     cout << setw(5) << " ";
     for (const auto& num : numbers) {
@@ -341,12 +477,23 @@ void printMatrix(const vector<string>& numbers, const vector<vector<int>>& matri
     // Output matrix with diagonal elements
     for (int i = 0; i < matrix.size(); ++i) {
         cout << setw(5) << numbers[i]; // Display line number
+        // In the sparse layout walk the known relations of the row instead of looking up every cell
+        map<int, int>::const_iterator known, end;
+        if (!matrix.isDense()) {
+            known = matrix.row(i).lower_bound(i);
+            end = matrix.row(i).end();
+        }
         for (int j = 0; j < matrix.size(); ++j) {
-            if (i == j) {
-                cout << setw(5) << matrix[i][j]; // Output diagonal elements
-            }
-            else if (i < j) {
-                cout << setw(5) << matrix[i][j]; // Output of the upper triangle
+            if (i <= j) {
+                int value = 0;
+                if (matrix.isDense()) {
+                    value = matrix.get(i, j);
+                }
+                else if (known != end && known->first == j) {
+                    value = known->second;
+                    ++known;
+                }
+                cout << setw(5) << value; // Output of the diagonal and the upper triangle
             }
             else {
                 cout << setw(5) << " "; // Space output for the bottom triangle
@@ -357,14 +504,14 @@ void printMatrix(const vector<string>& numbers, const vector<vector<int>>& matri
 }
 
 // Function to fill the diagonal with 2
-void fillDiagonalWithTwo(vector<vector<int>>& matrix, const vector<string>& numbers) {
+void fillDiagonalWithTwo(RelationStore& matrix, const vector<string>& numbers) {
     for (int i = 0; i < numbers.size(); ++i) {
-        matrix[i][i] = 2;
+        matrix.set(i, i, 2);
     }
 }
 
 // Function that print the matrix and let the user compare numbers
-void compareAndFillMatrix(vector<vector<int>>& matrix, const vector<string>& numbers, Comparator& comparator, MatrixObserver& observer) {
+void compareAndFillMatrix(RelationStore& matrix, const vector<string>& numbers, Comparator& comparator, MatrixObserver& observer) {
     cout << "Initial matrix:" << endl;
     for (int i = 0; i < numbers.size(); ++i) {
         for (int j = i + 1; j < numbers.size(); ++j) {
@@ -381,7 +528,7 @@ void compareAndFillMatrix(vector<vector<int>>& matrix, const vector<string>& num
 }
 
 // Function print print initial and final matrix
-void printInitialAndFinalMatrix(const vector<vector<int>>& matrix, const vector<string>& numbers) {
+void printInitialAndFinalMatrix(const RelationStore& matrix, const vector<string>& numbers) {
     cout << "Initial matrix:" << endl;
     printMatrix(numbers, matrix);
     cout << "Final matrix:" << endl;
@@ -512,7 +659,7 @@ void findBestAlternative(const int sortedInitialByEpors[4][4]) {
 // Function that tests our compairing numbers
 void test_compareNumbers(double& tests_passed)
 {
-    vector<vector<int>> matrix(12, vector<int>(12, 0));
+    RelationStore matrix(12);
     bool allTestsPassed = true;
 
     ComparatorFactory comparator_factory;
@@ -524,11 +671,11 @@ void test_compareNumbers(double& tests_passed)
         cout << "Test failed: Expected '2111' to be better than '3111'." << endl;
         allTestsPassed = false;
     }
-    if (matrix[0][1] != 1) {
+    if (matrix.get(0, 1) != 1) {
         cout << "Test failed: Matrix value not updated correctly for '2111' vs '3111'." << endl;
         allTestsPassed = false;
     }
-    if (matrix[1][0] != 0) {
+    if (matrix.get(1, 0) != 0) {
         cout << "Test failed: Matrix value updated incorrectly for '2111' vs '3111'." << endl;
         allTestsPassed = false;
     }
@@ -538,11 +685,11 @@ void test_compareNumbers(double& tests_passed)
         cout << "Test failed: Expected '3111' to be worse than '2111'." << endl;
         allTestsPassed = false;
     }
-    if (matrix[0][1] != 1) {
+    if (matrix.get(0, 1) != 1) {
         cout << "Test failed: Matrix value not updated correctly for '3111' vs '2111'." << endl;
         allTestsPassed = false;
     }
-    if (matrix[1][0] != 3) {
+    if (matrix.get(1, 0) != 3) {
         cout << "Test failed: Matrix value updated incorrectly for '3111' vs '2111'." << endl;
         allTestsPassed = false;
     }
@@ -552,7 +699,7 @@ void test_compareNumbers(double& tests_passed)
         cout << "Test failed: Expected '2111' and '2111' to be equal." << endl;
         allTestsPassed = false;
     }
-    if (matrix[0][0] != 2) {
+    if (matrix.get(0, 0) != 2) {
         cout << "Test failed: Matrix value not updated correctly for '2111' vs '2111'." << endl;
         allTestsPassed = false;
     }
@@ -628,7 +775,7 @@ void test_ranked_numbers(double& tests_passed)
 // Function that tests transitive relations in matrix due user choice
 void test_updateTransitiveRelations(double& tests_passed)
 {
-    vector<vector<int>> matrix = {
+    RelationStore matrix = vector<vector<int>>{
         {2, 1, 0, 0},
         {0, 2, 1, 0},
         {0, 0, 2, 1},
@@ -650,10 +797,10 @@ void test_updateTransitiveRelations(double& tests_passed)
     {
         for (int j = 0; j < matrix.size(); ++j)
         {
-            if (matrix[i][j] != expectedMatrix[i][j])
+            if (matrix.get(i, j) != expectedMatrix[i][j])
             {
                 cout << "Test failed: Matrix value not updated correctly at position [" << i << "][" << j << "]." << endl;
-                cout << "Expected: " << expectedMatrix[i][j] << ", got: " << matrix[i][j] << endl;
+                cout << "Expected: " << expectedMatrix[i][j] << ", got: " << matrix.get(i, j) << endl;
                 allTestsPassed = false;
             }
         }
@@ -669,3 +816,63 @@ void test_updateTransitiveRelations(double& tests_passed)
         cout << "test_updateTransitiveRelations failed." << endl << endl;
     }
 }
+
+// Function that tests that the sparse and dense layouts of the relation store give the same closure
+void test_relationStore(double& tests_passed)
+{
+    vector<vector<int>> initialMatrix(12, vector<int>(12, 0));
+    for (int i = 0; i < 12; ++i)
+    {
+        initialMatrix[i][i] = 2;
+    }
+    initialMatrix[0][1] = 1;
+    initialMatrix[1][4] = 2;
+    initialMatrix[4][7] = 1;
+    initialMatrix[3][2] = 3;
+    initialMatrix[2][6] = 3;
+    initialMatrix[6][9] = 2;
+
+    bool allTestsPassed = true;
+
+    RelationStore sparse = initialMatrix;
+    if (sparse.isDense())
+    {
+        cout << "Test failed: Store with " << sparse.knownCount() << " known relations should stay sparse." << endl;
+        allTestsPassed = false;
+    }
+
+    // Reference result: the same closure over the dense layout
+    RelationStore dense = initialMatrix;
+    dense.makeDense();
+
+    sparse.updateTransitiveRelations();
+    dense.updateTransitiveRelations();
+
+    for (int i = 0; i < 12; ++i)
+    {
+        for (int j = 0; j < 12; ++j)
+        {
+            if (sparse.get(i, j) != dense.get(i, j))
+            {
+                cout << "Test failed: Sparse and dense closures differ at position [" << i << "][" << j << "]." << endl;
+                cout << "Expected: " << dense.get(i, j) << ", got: " << sparse.get(i, j) << endl;
+                allTestsPassed = false;
+            }
+        }
+    }
+    if (sparse.get(0, 7) != 1 || sparse.get(3, 9) != 3 || sparse.knownCount() != dense.knownCount())
+    {
+        cout << "Test failed: Transitive relations not derived through known edges." << endl;
+        allTestsPassed = false;
+    }
+
+    if (allTestsPassed)
+    {
+        cout << "test_relationStore passed." << endl << endl;
+        tests_passed++;
+    }
+    else
+    {
+        cout << "test_relationStore failed." << endl << endl;
+    }
+}